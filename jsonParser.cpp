@@ -1,5 +1,8 @@
 #include "jsonParser.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 namespace json {
@@ -19,45 +22,46 @@ namespace json {
         return "UnknownType";
     }
 
-    // Error formating
-    std::string format_error(std::string base, std::string source, int index) {
+    // Error formating, shows at most this many bytes of the line on each
+    // side of the error, so minified single-line payloads stay cheap
+    const size_t error_context = 40;
+
+    std::string format_error(std::string base, std::string_view source,
+                             size_t index) {
         std::ostringstream s;
-        int counter = 0;
-        int line = 1;
-        int column = 0;
-        std::string lastline = "";
-        std::string indent = "";
-        for (auto c : source) {
-            if (counter == index) {
-                break;
-            }
+        index = std::min(index, source.size());
+
+        size_t line = 1 + std::count(source.begin(), source.begin() + index,
+                                     '\n');
+        size_t line_start = source.rfind('\n', index == 0 ? 0 : index - 1);
+        line_start = (line_start == std::string_view::npos ||
+                      line_start >= index) ? 0 : line_start + 1;
+        size_t line_end = source.find('\n', index);
+        if (line_end == std::string_view::npos) {
+            line_end = source.size();
+        }
+        size_t column = index - line_start;
+
+        size_t from = std::max(line_start,
+                               index > error_context ? index - error_context : 0);
+        size_t to = std::min(line_end, index + error_context);
 
-            if (c == '\n') {
-                line++;
-                column = 0;
-                lastline = "";
-                indent = "";
-            } else if (c == '\t') {
-                column++;
+        std::string lastline = from > line_start ? "..." : "";
+        std::string indent = from > line_start ? "   " : "";
+        for (size_t i = from; i < index; i++) {
+            if (source[i] == '\t') {
                 lastline += "  ";
                 indent += "  ";
             } else {
-                column++;
-                lastline += c;
+                lastline += source[i];
                 indent += " ";
             }
-
-            counter++;
         }
 
         // Continue accumulating the lastline for debugging
-        while (counter < source.size()) {
-            auto c = source[counter];
-            if (c == '\n') {
-                break;
-            }
-            lastline += c;
-            counter++;
+        lastline += source.substr(index, to - index);
+        if (to < line_end) {
+            lastline += "...";
         }
 
         s << base << " at line " << line << ", column " << column << std::endl;
@@ -423,6 +427,474 @@ namespace json {
         return {ast, error1};
     }
 
+    // Validation
+    struct ValidationState {
+        const char* begin;
+        const char* p;
+        const char* end;
+        int depth;
+        int max_depth;
+        const char* error;  // First error message, set once validation fails
+        const char* error_at;
+    };
+
+    bool validation_error(ValidationState& s, const char* message,
+                          const char* at) {
+        s.error = message;
+        s.error_at = at;
+        return false;
+    }
+
+    bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool is_hex_digit(char c) {
+        return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    bool is_whitespace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool is_string_special(char c) {
+        auto u = static_cast<unsigned char>(c);
+        return c == '"' || c == '\\' || u < 0x20 || u >= 0x80;
+    }
+
+    bool is_not_whitespace(char c) {
+        return !is_whitespace(c);
+    }
+
+    bool is_not_digit(char c) {
+        return !is_digit(c);
+    }
+
+    // SWAR helpers: a word holds 8 input bytes, and every mask has the high
+    // bit set in exactly the bytes that match, with no carries between bytes
+    const uint64_t swar_ones = 0x0101010101010101ULL;
+    const uint64_t swar_high = 0x8080808080808080ULL;
+    const uint64_t swar_low = 0x7F7F7F7F7F7F7F7FULL;
+
+    // Byte i of the input is byte i of the word on any platform, compilers
+    // turn this into a single load on little endian ones
+    uint64_t load_word(const char* p) {
+        auto u = reinterpret_cast<const unsigned char*>(p);
+        return uint64_t(u[0]) | uint64_t(u[1]) << 8 | uint64_t(u[2]) << 16 |
+               uint64_t(u[3]) << 24 | uint64_t(u[4]) << 32 |
+               uint64_t(u[5]) << 40 | uint64_t(u[6]) << 48 |
+               uint64_t(u[7]) << 56;
+    }
+
+    uint64_t bytes_equal(uint64_t word, char c) {
+        uint64_t x = word ^ (swar_ones * static_cast<unsigned char>(c));
+        return ~(((x & swar_low) + swar_low) | x) & swar_high;
+    }
+
+    // '"', '\\', control characters and non-ASCII bytes end a plain string run
+    uint64_t string_special_bytes(uint64_t word) {
+        uint64_t control =
+            ~((word & swar_low) + swar_ones * (0x80 - 0x20)) & swar_high;
+        return bytes_equal(word, '"') | bytes_equal(word, '\\') |
+               control | (word & swar_high);
+    }
+
+    uint64_t non_whitespace_bytes(uint64_t word) {
+        return ~(bytes_equal(word, ' ') | bytes_equal(word, '\n') |
+                 bytes_equal(word, '\r') | bytes_equal(word, '\t')) & swar_high;
+    }
+
+    // After xor with '0' a digit byte is 0-9, anything else is above 9
+    uint64_t non_digit_bytes(uint64_t word) {
+        uint64_t x = word ^ (swar_ones * '0');
+        return (((x & swar_low) + swar_ones * (0x80 - 10)) | x) & swar_high;
+    }
+
+    // Offset of the first input byte flagged in a non-zero mask: the lowest
+    // flag shifted down is 1 << 8 * i, and the multiply moves i to the top
+    int first_flagged_byte(uint64_t mask) {
+        uint64_t lowest = (mask & (~mask + 1)) >> 7;
+        return static_cast<int>((lowest * 0x0001020304050607ULL) >> 56);
+    }
+
+    // Skips to the first flagged byte, a word at a time while 8 bytes are
+    // left; flagged_bytes and is_flagged must agree on which bytes stop
+    template <uint64_t (*flagged_bytes)(uint64_t), bool (*is_flagged)(char)>
+    const char* skip_until(const char* p, const char* end) {
+        while (end - p >= 8) {
+            if (uint64_t mask = flagged_bytes(load_word(p)); mask != 0) {
+                return p + first_flagged_byte(mask);
+            }
+            p += 8;
+        }
+
+        while (p != end && !is_flagged(*p)) {
+            p++;
+        }
+        return p;
+    }
+
+    // Runs are skipped in their own function so the word loop isn't inlined
+    // into every caller, which measurably slows the structural path down
+    void skip_whitespace_run(ValidationState& s) {
+        s.p = skip_until<non_whitespace_bytes, is_not_whitespace>(s.p + 1,
+                                                                  s.end);
+    }
+
+    // Minified input rarely has any, so check one byte before the words;
+    // inline keeps this check in the callers once the run is split out
+    inline void validate_whitespace(ValidationState& s) {
+        if (s.p != s.end && is_whitespace(*s.p)) {
+            skip_whitespace_run(s);
+        }
+    }
+
+    bool validate_value(ValidationState& s);
+
+    int hex_digit_value(char c) {
+        if (is_digit(c)) {
+            return c - '0';
+        }
+        return (c | 0x20) - 'a' + 10;
+    }
+
+    // Reads the 4 hex digits of a \uXXXX escape, s.p points at the backslash
+    bool validate_unicode_escape(ValidationState& s, int& code_unit) {
+        const char* start = s.p;
+        if (s.end - s.p < 2 || s.p[0] != '\\' || s.p[1] != 'u') {
+            return false;
+        }
+        s.p += 2;
+
+        code_unit = 0;
+        for (int i = 0; i < 4; i++, s.p++) {
+            if (s.p == s.end || !is_hex_digit(*s.p)) {
+                s.p = start;
+                return false;
+            }
+            code_unit = code_unit * 16 + hex_digit_value(*s.p);
+        }
+        return true;
+    }
+
+    bool validate_escape(ValidationState& s) {
+        const char* start = s.p;
+        if (s.p + 1 == s.end) {
+            return validation_error(s, "Unexpected EOF while validating string",
+                                    s.p + 1);
+        }
+
+        switch (s.p[1]) {
+            case '"': case '\\': case '/':
+            case 'b': case 'f': case 'n': case 'r': case 't':
+                s.p += 2;
+                return true;
+            case 'u': {
+                int code_unit;
+                if (!validate_unicode_escape(s, code_unit)) {
+                    return validation_error(
+                        s, "Invalid unicode escape in string", start);
+                }
+
+                // Surrogates must come as a high and low pair, the same
+                // code points are rejected as raw UTF-8 in validate_utf8
+                if (code_unit >= 0xDC00 && code_unit <= 0xDFFF) {
+                    return validation_error(
+                        s, "Unpaired surrogate escape in string", start);
+                }
+                if (code_unit >= 0xD800 && code_unit <= 0xDBFF) {
+                    if (!validate_unicode_escape(s, code_unit) ||
+                        code_unit < 0xDC00 || code_unit > 0xDFFF) {
+                        return validation_error(
+                            s, "Unpaired surrogate escape in string", start);
+                    }
+                }
+                return true;
+            }
+        }
+
+        return validation_error(s, "Invalid escape sequence in string", start);
+    }
+
+    // Well-formed UTF-8 sequences as listed in Unicode Table 3-7:
+    // no overlong forms, no surrogates, nothing above U+10FFFF
+    bool validate_utf8(ValidationState& s) {
+        auto u = reinterpret_cast<const unsigned char*>(s.p);
+        unsigned char lo = 0x80;
+        unsigned char hi = 0xBF;
+        int length;
+        if (u[0] >= 0xC2 && u[0] <= 0xDF) {
+            length = 2;
+        } else if (u[0] >= 0xE0 && u[0] <= 0xEF) {
+            length = 3;
+            if (u[0] == 0xE0) {
+                lo = 0xA0;
+            } else if (u[0] == 0xED) {
+                hi = 0x9F;
+            }
+        } else if (u[0] >= 0xF0 && u[0] <= 0xF4) {
+            length = 4;
+            if (u[0] == 0xF0) {
+                lo = 0x90;
+            } else if (u[0] == 0xF4) {
+                hi = 0x8F;
+            }
+        } else {
+            return validation_error(s, "Invalid UTF-8 in string", s.p);
+        }
+
+        if (s.end - s.p < length || u[1] < lo || u[1] > hi) {
+            return validation_error(s, "Invalid UTF-8 in string", s.p);
+        }
+        for (int i = 2; i < length; i++) {
+            if ((u[i] & 0xC0) != 0x80) {
+                return validation_error(s, "Invalid UTF-8 in string", s.p);
+            }
+        }
+
+        s.p += length;
+        return true;
+    }
+
+    bool validate_string(ValidationState& s) {
+        s.p++;
+        while (true) {
+            s.p = skip_until<string_special_bytes, is_string_special>(s.p,
+                                                                      s.end);
+            if (s.p == s.end) {
+                return validation_error(
+                    s, "Unexpected EOF while validating string", s.p);
+            }
+
+            auto c = static_cast<unsigned char>(*s.p);
+            if (c == '"') {
+                s.p++;
+                return true;
+            }
+
+            if (c == '\\') {
+                if (!validate_escape(s)) {
+                    return false;
+                }
+            } else if (c < 0x20) {
+                return validation_error(
+                    s, "Unescaped control character in string", s.p);
+            } else if (!validate_utf8(s)) {
+                return false;
+            }
+        }
+    }
+
+    void skip_digit_run(ValidationState& s) {
+        s.p = skip_until<non_digit_bytes, is_not_digit>(s.p + 1, s.end);
+    }
+
+    bool validate_digits(ValidationState& s, const char* start) {
+        if (s.p == s.end || !is_digit(*s.p)) {
+            return validation_error(s, "Invalid number", start);
+        }
+        s.p++;
+
+        // Most runs are a few digits, only longer ones go through the words
+        for (int i = 0; i < 3; i++, s.p++) {
+            if (s.p == s.end || !is_digit(*s.p)) {
+                return true;
+            }
+        }
+        if (s.p != s.end && is_digit(*s.p)) {
+            skip_digit_run(s);
+        }
+        return true;
+    }
+
+    // -? (0 | [1-9][0-9]*) (.[0-9]+)? ([eE][+-]?[0-9]+)?
+    bool validate_number(ValidationState& s) {
+        const char* start = s.p;
+        if (*s.p == '-') {
+            s.p++;
+        }
+
+        if (s.p != s.end && *s.p == '0') {
+            s.p++;
+            if (s.p != s.end && is_digit(*s.p)) {
+                return validation_error(s, "Invalid number", start);
+            }
+        } else if (!validate_digits(s, start)) {
+            return false;
+        }
+
+        if (s.p != s.end && *s.p == '.') {
+            s.p++;
+            if (!validate_digits(s, start)) {
+                return false;
+            }
+        }
+
+        if (s.p != s.end && (*s.p == 'e' || *s.p == 'E')) {
+            s.p++;
+            if (s.p != s.end && (*s.p == '+' || *s.p == '-')) {
+                s.p++;
+            }
+            if (!validate_digits(s, start)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool validate_keyword(ValidationState& s, const char* keyword,
+                          size_t length) {
+        if (static_cast<size_t>(s.end - s.p) < length ||
+            std::memcmp(s.p, keyword, length) != 0) {
+            return validation_error(s, "Invalid literal", s.p);
+        }
+
+        s.p += length;
+        return true;
+    }
+
+    bool validate_array(ValidationState& s) {
+        if (++s.depth > s.max_depth) {
+            return validation_error(s, "Maximum nesting depth exceeded", s.p);
+        }
+        s.p++;
+
+        validate_whitespace(s);
+        if (s.p != s.end && *s.p == ']') {
+            s.p++;
+            s.depth--;
+            return true;
+        }
+
+        while (true) {
+            if (!validate_value(s)) {
+                return false;
+            }
+
+            validate_whitespace(s);
+            if (s.p == s.end) {
+                return validation_error(
+                    s, "Unexpected EOF while validating array", s.p);
+            }
+
+            if (*s.p == ']') {
+                s.p++;
+                s.depth--;
+                return true;
+            }
+
+            if (*s.p != ',') {
+                return validation_error(
+                    s, "Expected comma after element in array", s.p);
+            }
+            s.p++;
+        }
+    }
+
+    bool validate_object(ValidationState& s) {
+        if (++s.depth > s.max_depth) {
+            return validation_error(s, "Maximum nesting depth exceeded", s.p);
+        }
+        s.p++;
+
+        validate_whitespace(s);
+        if (s.p != s.end && *s.p == '}') {
+            s.p++;
+            s.depth--;
+            return true;
+        }
+
+        while (true) {
+            validate_whitespace(s);
+            if (s.p == s.end) {
+                return validation_error(
+                    s, "Unexpected EOF while validating object", s.p);
+            }
+
+            if (*s.p != '"') {
+                return validation_error(s, "Expected string key in object", s.p);
+            }
+            if (!validate_string(s)) {
+                return false;
+            }
+
+            validate_whitespace(s);
+            if (s.p == s.end || *s.p != ':') {
+                return validation_error(
+                    s, "Expected colon after key in object", s.p);
+            }
+            s.p++;
+
+            if (!validate_value(s)) {
+                return false;
+            }
+
+            validate_whitespace(s);
+            if (s.p == s.end) {
+                return validation_error(
+                    s, "Unexpected EOF while validating object", s.p);
+            }
+
+            if (*s.p == '}') {
+                s.p++;
+                s.depth--;
+                return true;
+            }
+
+            if (*s.p != ',') {
+                return validation_error(
+                    s, "Expected comma after element in object", s.p);
+            }
+            s.p++;
+        }
+    }
+
+    bool validate_value(ValidationState& s) {
+        validate_whitespace(s);
+        if (s.p == s.end) {
+            return validation_error(s, "Unexpected EOF while validating value",
+                                    s.p);
+        }
+
+        switch (*s.p) {
+            case '{':
+                return validate_object(s);
+            case '[':
+                return validate_array(s);
+            case '"':
+                return validate_string(s);
+            case 't':
+                return validate_keyword(s, "true", 4);
+            case 'f':
+                return validate_keyword(s, "false", 5);
+            case 'n':
+                return validate_keyword(s, "null", 4);
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                return validate_number(s);
+        }
+
+        return validation_error(s, "Expected value", s.p);
+    }
+
+    std::string validate(std::string_view raw_json, int max_depth) {
+        const char* begin = raw_json.data();
+        ValidationState s{begin, begin, begin + raw_json.size(),
+                          0, max_depth, nullptr, nullptr};
+
+        if (validate_value(s)) {
+            validate_whitespace(s);
+            if (s.p == s.end) {
+                return "";
+            }
+            validation_error(s, "Unexpected trailing data", s.p);
+        }
+
+        return format_error(s.error, raw_json,
+                            static_cast<size_t>(s.error_at - s.begin));
+    }
+
     std::string stringify(JSONValue v, std::string indent) {
         switch (v.type) {
             case JSONValueType::String:
@@ -1,4 +1,5 @@
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -40,6 +41,12 @@ namespace json {
     parse(std::vector<JSONToken> tokens, int index = 0);
 
     std::tuple<JSONValue, std::string> lexify_and_parse(std::string raw_json);
+
+    // Strict RFC 8259 check without building tokens or nodes,
+    // surrogate escapes must be paired like raw UTF-8,
+    // returns the formatted first error or an empty string
+    std::string validate(std::string_view raw_json, int max_depth = 512);
+
     std::string stringify(JSONValue value, std::string indent = "");
 
     // Expression
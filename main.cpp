@@ -6,16 +6,40 @@
 
 bool check_number_of_arguments(int argc) {
     if (argc != 3) {
-        std::cerr << "Usage: {json_file_path} {json_expression}";
+        std::cerr << "Usage: {json_file_path} {json_expression}" << std::endl
+                  << "       --validate {json_file_path}";
         return false;
     }
     return true;
 }
 
+int validate_json_file(std::string file_path) {
+    auto [raw_json, error] = get_raw_file(file_path);
+
+    if (!error.empty()) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    auto error1 = json::validate(raw_json);
+
+    if (!error1.empty()) {
+        std::cerr << error1 << std::endl;
+        return 1;
+    }
+
+    std::cout << "Valid JSON";
+
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     if (!check_number_of_arguments(argc))
         return 1;
 
+    if (std::string(argv[1]) == "--validate")
+        return validate_json_file(argv[2]);
+
     std::string file_path = argv[1];
     std::string json_expression = argv[2];
 
@@ -0,0 +1,72 @@
+#include "../jsonParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+
+// Build a mixed document: minified records followed by indented ones
+std::string make_document(size_t target_size) {
+    std::string minified = "[";
+    std::string indented = "[\n";
+    for (int i = 0; minified.size() + indented.size() < target_size; i++) {
+        std::string id = std::to_string(i);
+        std::string record =
+            "{\"id\":" + id + ",\"name\":\"user " + id + " caf\xc3\xa9\","
+            "\"tags\":[\"alpha\",\"beta\"],\"score\":-" + id + ".25e-3,"
+            "\"active\":true,\"parent\":null,"
+            "\"bio\":\"lorem ipsum dolor sit amet, \\\"quoted\\\"\\n\"}";
+        minified += (i ? "," : "") + record;
+        indented += std::string(i ? ",\n" : "") +
+            "    {\n"
+            "        \"id\": " + id + ",\n"
+            "        \"values\": [1024, 2048, 4096, 3.14159],\n"
+            "        \"label\": \"item " + id + "\"\n"
+            "    }";
+    }
+    return "{\"minified\": " + minified + "],\n\"indented\": " + indented +
+           "\n]}\n";
+}
+
+// Usage: {size_in_mb} {runs}, both optional
+int main(int argc, char* argv[]) {
+    size_t size_mb = argc > 1 ? std::stoul(argv[1]) : 200;
+    int runs = argc > 2 ? std::stoi(argv[2]) : 10;
+    std::string document = make_document(size_mb * 1024 * 1024);
+
+    // Reference: memchr for a byte the document doesn't contain reads the
+    // whole buffer, close to what memory bandwidth allows on this machine
+    double scan_best = 0;
+    bool found = false;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        found |= std::memchr(document.data(), '\0', document.size()) != nullptr;
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        scan_best = std::max(scan_best,
+                             document.size() / elapsed.count() / 1e9);
+    }
+
+    double best = 0;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto error = json::validate(document);
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        if (!error.empty()) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        best = std::max(best, document.size() / elapsed.count() / 1e9);
+    }
+
+    std::cout << "scan:     " << document.size() / (1024 * 1024) << " MB, "
+              << scan_best << " GB/s" << (found ? " (found NUL)" : "")
+              << std::endl;
+    std::cout << "validate: " << document.size() / (1024 * 1024) << " MB, "
+              << best << " GB/s (best of " << runs << ")" << std::endl;
+
+    return 0;
+}
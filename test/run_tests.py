@@ -11,9 +11,9 @@ def run_test(test: str, path_to_built_app: str) -> str:
     )
 
     if not result.stdout:
-        return result.stderr.decode("utf-8")
+        return result.stderr.decode("utf-8", errors="replace")
 
-    return result.stdout.decode("utf-8")
+    return result.stdout.decode("utf-8", errors="replace")
 
 
 def check_number_of_arguments(argc: int) -> bool:
@@ -2,20 +2,66 @@
 #include <string>
 
 
+// Open the JSON file, get an error message if it can't be opened
+std::string open_json_file(std::ifstream& json_file, std::string file_path,
+                           std::ios::openmode mode = std::ios::in) {
+    json_file.open(file_path, mode);
+
+    if (!json_file.is_open()) {
+        return "Unable to open file \"" + file_path + "\"";
+    }
+
+    return "";
+}
+
 // Open and read the JSON file, get a raw JSON string
 std::tuple<std::string, std::string> get_raw_json(std::string file_path) {
     std::string raw_json;
     std::string tmp_line;
-    std::ifstream json_file(file_path);
-
-    if (json_file.is_open()) {
-        while (std::getline(json_file, tmp_line)) {
-            raw_json += tmp_line;
-        }
-        json_file.close();
-    } else {
-        return {"", "Unable to open file \"" + file_path + "\""};
+    std::ifstream json_file;
+
+    if (auto error = open_json_file(json_file, file_path); !error.empty()) {
+        return {"", error};
+    }
+
+    while (std::getline(json_file, tmp_line)) {
+        raw_json += tmp_line;
+    }
+    json_file.close();
+
+    return {raw_json, ""};
+}
+
+// Open and read the whole file as is, keeping line breaks for validation
+std::tuple<std::string, std::string> get_raw_file(std::string file_path) {
+    std::string raw_json;
+    std::ifstream json_file;
+
+    if (auto error = open_json_file(json_file, file_path, std::ios::binary);
+        !error.empty()) {
+        return {"", error};
+    }
+
+    // Directories open fine on Linux and even report a size, but can't be read
+    json_file.peek();
+    if (json_file.fail()) {
+        return {"", "Unable to read file \"" + file_path + "\""};
+    }
+    json_file.clear();
+
+    json_file.seekg(0, std::ios::end);
+    std::streampos size = json_file.tellg();
+    if (size == std::streampos(-1) ||
+        static_cast<unsigned long long>(size) > raw_json.max_size()) {
+        return {"", "Unable to read file \"" + file_path + "\""};
+    }
+
+    raw_json.resize(static_cast<size_t>(size));
+    json_file.seekg(0, std::ios::beg);
+    if (!json_file.read(raw_json.data(), raw_json.size())) {
+        return {"", "Unable to read file \"" + file_path + "\""};
     }
+    json_file.close();
 
     return {raw_json, ""};
 }